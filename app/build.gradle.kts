@@ -19,6 +19,10 @@ android {
         sourceCompatibility = JavaVersion.VERSION_21
         targetCompatibility = JavaVersion.VERSION_21
     }
+    testOptions {
+        // AAudioConstants logs unknown values through android.util.Log
+        unitTests.isReturnDefaultValues = true
+    }
     externalNativeBuild {
         cmake {
             path = file("src/main/cpp/CMakeLists.txt")
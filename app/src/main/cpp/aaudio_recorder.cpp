@@ -1,17 +1,31 @@
 #include "aaudio_recorder.h"
+#include <algorithm>
 #include <atomic>
 #include <chrono>
+#include <climits> // for PATH_MAX
+#include <cstdlib> // for realpath
 #include <cstring> // for memcpy
 #include <iomanip>
 #include <jni.h>
 #include <memory>
 #include <sstream>
 #include <string>
+#include <sys/stat.h>
+#include <sys/statvfs.h>
+
+// Reason the data or error callback stopped recording
+enum class StopReason : int32_t {
+    NONE = 0,
+    WRITER_UNAVAILABLE = 1,
+    WRITE_FAILED = 2,
+    STORAGE_FULL = 3,
+    STREAM_ERROR = 4,
+};
 
 // Simplified recorder state structure
 struct AudioRecorderState {
     AAudioStream* stream = nullptr;
-    std::unique_ptr<WavFileWriter> wavWriter;
+    std::unique_ptr<WavFileWriter> wavWriter; // Written by the data callback while recording
     std::atomic<bool> isRecording{false};
 
     // Java callback related
@@ -20,6 +34,7 @@ struct AudioRecorderState {
     jmethodID onRecordingStartedMethod = nullptr;
     jmethodID onRecordingStoppedMethod = nullptr;
     jmethodID onRecordingErrorMethod = nullptr;
+    jmethodID onStorageStateChangedMethod = nullptr;
 
     // Configuration parameters
     aaudio_input_preset_t inputPreset = AAUDIO_INPUT_PRESET_GENERIC;
@@ -29,8 +44,42 @@ struct AudioRecorderState {
     aaudio_performance_mode_t performanceMode = AAUDIO_PERFORMANCE_MODE_LOW_LATENCY;
     aaudio_sharing_mode_t sharingMode = AAUDIO_SHARING_MODE_SHARED;
     std::string outputPath = "/data/";
+
+    // Storage monitoring parameters
+    int32_t lowSpaceSeconds = 60;
+    int32_t criticalSeconds = 10;
+    StorageAction storageAction = StorageAction::STOP;
+    std::string fallbackDir;
+
+    // Storage monitoring state, owned by the notifier thread while recording
+    StorageMonitor storageMonitor;
+    StorageState storageState = StorageState::NORMAL;
+    std::string segmentBaseName;                           // File name of the first segment without extension
+    int32_t segmentIndex = 0;                              // Index of the last segment file
+    std::string segmentFilePath;                           // File of the current or next segment
+    aaudio_format_t segmentFormat = AAUDIO_FORMAT_PCM_I16; // Storage format of the current or next segment
+    int32_t maxFramesPerWrite = 0;                         // Largest data callback in frames
+
+    // Segment handover, each slot holds at most one writer so the data callback never opens or closes files
+    std::atomic<WavFileWriter*> nextWavWriter{nullptr};    // Opened by the notifier, taken by the callback
+    std::atomic<WavFileWriter*> retiredWavWriter{nullptr}; // Replaced by the callback, closed by the notifier
+    std::atomic<bool> storageStopRequested{false};         // Storage action STOP, carried out by the callback
+
+    // Notifier thread, attached to the JVM, monitors storage and delivers events raised on AAudio threads to Java
+    std::thread notifierThread;
+    std::mutex notifierMutex;
+    std::condition_variable notifierCondition;
+    bool notifierRunning = false;                // Guarded by notifierMutex
+    std::atomic<uint32_t> notifierGeneration{0}; // Changes when the notifier thread is replaced or abandoned
+
+    // Events raised on AAudio threads, published through atomics so callbacks never block or call into Java
+    std::atomic<int32_t> stopReason{0};
+    std::atomic<aaudio_result_t> streamError{AAUDIO_OK};
 };
 
+// Interval at which the notifier thread checks storage and pending events
+static constexpr std::chrono::milliseconds NOTIFIER_INTERVAL{100};
+
 static AudioRecorderState g_recorder;
 
 // Simplified Java callbacks
@@ -63,6 +112,282 @@ static void notifyRecordingError(const std::string& error) {
     }
 }
 
+static void notifyStorageStateChanged(int32_t state, int32_t action, uint64_t freeBytes, int64_t secondsToFull) {
+    if (g_recorder.jvm && g_recorder.recorderInstance && g_recorder.onStorageStateChangedMethod) {
+        JNIEnv* env;
+        if (g_recorder.jvm->GetEnv((void**)&env, JNI_VERSION_1_6) == JNI_OK) {
+            env->CallVoidMethod(g_recorder.recorderInstance, g_recorder.onStorageStateChangedMethod,
+                                static_cast<jint>(state), static_cast<jint>(action), static_cast<jlong>(freeBytes),
+                                static_cast<jlong>(secondsToFull));
+        }
+    }
+}
+
+// Get error message for stop reason
+static std::string getStopReasonMessage(StopReason reason) {
+    switch (reason) {
+    case StopReason::WRITER_UNAVAILABLE:
+        return "WAV file writer not opened";
+    case StopReason::WRITE_FAILED:
+        return "Failed to write audio data";
+    case StopReason::STORAGE_FULL:
+        return "Recording stopped: storage almost full";
+    case StopReason::STREAM_ERROR:
+        return std::string("Recording stream error: ") +
+               AAudio_convertResultToText(g_recorder.streamError.load(std::memory_order_acquire));
+    default:
+        return "Recording stopped";
+    }
+}
+
+// Close the segment the data callback switched away from
+static void closeRetiredSegment() {
+    std::unique_ptr<WavFileWriter> retired(g_recorder.retiredWavWriter.exchange(nullptr, std::memory_order_acquire));
+    if (retired) {
+        retired->close();
+    }
+}
+
+// Stop and close stream and WAV files of the current or a callback-stopped recording
+static void closeRecordingResources() {
+    if (g_recorder.stream) {
+        aaudio_result_t result = AAudioStream_requestStop(g_recorder.stream);
+        if (result != AAUDIO_OK) {
+            LOGW("Failed to stop stream: %s", AAudio_convertResultToText(result));
+        }
+
+        result = AAudioStream_close(g_recorder.stream);
+        if (result != AAUDIO_OK) {
+            LOGW("Failed to close stream: %s", AAudio_convertResultToText(result));
+        }
+        g_recorder.stream = nullptr;
+    }
+
+    closeRetiredSegment();
+    if (g_recorder.wavWriter) {
+        g_recorder.wavWriter->close();
+        g_recorder.wavWriter.reset();
+    }
+
+    // Segment prepared by the notifier but never taken by the callback
+    std::unique_ptr<WavFileWriter> next(g_recorder.nextWavWriter.exchange(nullptr, std::memory_order_acquire));
+    if (next) {
+        next->close();
+    }
+}
+
+// Get rate audio is stored at in the given storage format
+static double getDataBytesPerSecond(aaudio_format_t storageFormat) {
+    return static_cast<double>(g_recorder.sampleRate) * g_recorder.channelCount *
+           WavFileWriter::getBytesPerSample(storageFormat);
+}
+
+// Get file name without directory and .wav extension
+static std::string getSegmentBaseName(const std::string& filePath) {
+    std::string fileName = filePath;
+    size_t pos = fileName.find_last_of('/');
+    if (pos != std::string::npos) {
+        fileName = fileName.substr(pos + 1);
+    }
+
+    if (fileName.length() > 4 && fileName.substr(fileName.length() - 4) == ".wav") {
+        fileName = fileName.substr(0, fileName.length() - 4);
+    }
+    return fileName;
+}
+
+// Generate next segment file path in directory, based on the first segment's file name
+static std::string getSegmentFilePath(const std::string& directory) {
+    std::ostringstream oss;
+    oss << directory;
+    if (directory.empty() || directory.back() != '/') {
+        oss << "/";
+    }
+    oss << g_recorder.segmentBaseName << "_part" << ++g_recorder.segmentIndex << ".wav";
+    return oss.str();
+}
+
+// Open the next segment file and hand it to the data callback, which switches to it at its next buffer
+static bool prepareSegment(const std::string& directory, aaudio_format_t storageFormat) {
+    std::string filePath = getSegmentFilePath(directory);
+    auto writer = std::make_unique<WavFileWriter>();
+    if (!writer->open(filePath, g_recorder.sampleRate, g_recorder.channelCount, g_recorder.format, storageFormat)) {
+        return false;
+    }
+    writer->setMaxFramesPerWrite(g_recorder.maxFramesPerWrite);
+    writer->setStorageMonitor(&g_recorder.storageMonitor);
+
+    g_recorder.segmentFilePath = filePath;
+    g_recorder.segmentFormat = writer->getStorageFormat();
+    g_recorder.storageMonitor.reset(filePath, getDataBytesPerSecond(g_recorder.segmentFormat));
+    g_recorder.nextWavWriter.store(writer.release(), std::memory_order_release);
+    return true;
+}
+
+// Check the fallback directory is on another filesystem with room for more than the critical time of recording
+static bool canRotateToFallback() {
+    if (g_recorder.fallbackDir.empty()) {
+        return false;
+    }
+
+    std::string currentDir = StorageMonitor::resolveDirectory(StorageMonitor::getDirectory(g_recorder.segmentFilePath));
+    std::string fallbackDir = StorageMonitor::resolveDirectory(g_recorder.fallbackDir);
+    if (StorageMonitor::isSameFilesystem(currentDir, fallbackDir)) {
+        LOGW("Fallback directory is on the same filesystem: %s", fallbackDir.c_str());
+        return false;
+    }
+
+    uint64_t freeBytes = 0;
+    if (!StorageMonitor::queryFreeBytes(fallbackDir, freeBytes) ||
+        static_cast<double>(freeBytes) / getDataBytesPerSecond(g_recorder.segmentFormat) <=
+            static_cast<double>(g_recorder.criticalSeconds)) {
+        LOGW("Fallback directory has no room: %s", fallbackDir.c_str());
+        return false;
+    }
+    return true;
+}
+
+// Apply configured storage action, returns the action actually taken
+static StorageAction applyStorageAction() {
+    switch (g_recorder.storageAction) {
+    case StorageAction::NONE:
+        return StorageAction::NONE;
+    case StorageAction::DOWNGRADE_FORMAT:
+        if (g_recorder.segmentFormat != AAUDIO_FORMAT_PCM_I16 &&
+            prepareSegment(StorageMonitor::getDirectory(g_recorder.segmentFilePath), AAUDIO_FORMAT_PCM_I16)) {
+            LOGW("Storage critical, continuing in 16-bit: %s", g_recorder.segmentFilePath.c_str());
+            return StorageAction::DOWNGRADE_FORMAT;
+        }
+        break;
+    case StorageAction::ROTATE_DIRECTORY:
+        if (canRotateToFallback() && prepareSegment(g_recorder.fallbackDir, g_recorder.segmentFormat)) {
+            LOGW("Storage critical, continuing in fallback directory: %s", g_recorder.segmentFilePath.c_str());
+            return StorageAction::ROTATE_DIRECTORY;
+        }
+        break;
+    case StorageAction::STOP:
+        break;
+    }
+
+    // Preferred action not possible, stop before the disk fills up
+    LOGW("Storage critical, stopping recording: %s", g_recorder.segmentFilePath.c_str());
+    g_recorder.storageStopRequested.store(true, std::memory_order_release);
+    return StorageAction::STOP;
+}
+
+// Check storage health and degrade before writes start failing (notifier thread only)
+static void checkStorage() {
+    closeRetiredSegment();
+
+    // Nothing to do until the callback has taken a prepared segment or carried out a stop
+    if (!g_recorder.isRecording.load(std::memory_order_acquire) ||
+        g_recorder.storageStopRequested.load(std::memory_order_acquire) ||
+        g_recorder.nextWavWriter.load(std::memory_order_acquire) != nullptr) {
+        return;
+    }
+
+    StorageStatus status;
+    uint64_t fileBytes = std::min(g_recorder.storageMonitor.getFileBytes(), WavFileWriter::getMaxDataSize());
+    if (!g_recorder.storageMonitor.poll(WavFileWriter::getMaxDataSize() - fileBytes, status)) {
+        return;
+    }
+
+    StorageAction action = StorageAction::NONE;
+    if (status.state == StorageState::CRITICAL) {
+        action = applyStorageAction();
+    }
+
+    if (status.state != g_recorder.storageState || action != StorageAction::NONE) {
+        LOGI("Storage state: %d, action: %d, free: %llu bytes, time to full: %lld s, throughput: %.0f B/s",
+             static_cast<int>(status.state), static_cast<int>(action),
+             static_cast<unsigned long long>(status.freeBytes), static_cast<long long>(status.secondsToFull),
+             status.writeBytesPerSecond);
+        g_recorder.storageState = status.state;
+        notifyStorageStateChanged(static_cast<int32_t>(status.state), static_cast<int32_t>(action), status.freeBytes,
+                                  status.secondsToFull);
+    }
+}
+
+// Tear down a recording stopped by a callback and report it (notifier thread only)
+static void deliverStopReason() {
+    auto reason = static_cast<StopReason>(g_recorder.stopReason.exchange(0, std::memory_order_acq_rel));
+    if (reason != StopReason::NONE) {
+        // Callback stopped recording, release the microphone and finalize the file off the callback thread
+        closeRecordingResources();
+        notifyRecordingError(getStopReasonMessage(reason));
+    }
+}
+
+// Whether the calling notifier thread still serves the recorder, a Java callback on it may have stopped or restarted
+// recording, leaving it to exit once the callback returns
+static bool isCurrentNotifier(uint32_t generation) {
+    return g_recorder.notifierGeneration.load(std::memory_order_acquire) == generation;
+}
+
+static void notifierLoop(uint32_t generation) {
+    // Keep the VM, a Java callback on this thread may call releaseNative()
+    JavaVM* jvm = g_recorder.jvm;
+    JNIEnv* env = nullptr;
+    if (jvm->AttachCurrentThread(&env, nullptr) != JNI_OK) {
+        LOGE("Failed to attach notifier thread to JVM");
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(g_recorder.notifierMutex);
+    while (g_recorder.notifierRunning && isCurrentNotifier(generation)) {
+        g_recorder.notifierCondition.wait_for(lock, NOTIFIER_INTERVAL);
+        lock.unlock();
+        checkStorage();
+        if (isCurrentNotifier(generation)) {
+            deliverStopReason();
+        }
+        lock.lock();
+    }
+    lock.unlock();
+
+    // Deliver a stop raised right before the notifier was stopped
+    if (isCurrentNotifier(generation)) {
+        deliverStopReason();
+    }
+    jvm->DetachCurrentThread();
+}
+
+static void startNotifier() {
+    if (g_recorder.jvm == nullptr) {
+        LOGW("JVM not available, events from AAudio threads will not be reported");
+        return;
+    }
+
+    g_recorder.stopReason.store(static_cast<int32_t>(StopReason::NONE), std::memory_order_release);
+    g_recorder.storageStopRequested.store(false, std::memory_order_release);
+    {
+        std::lock_guard<std::mutex> lock(g_recorder.notifierMutex);
+        g_recorder.notifierRunning = true;
+    }
+    uint32_t generation = g_recorder.notifierGeneration.fetch_add(1, std::memory_order_acq_rel) + 1;
+    g_recorder.notifierThread = std::thread(notifierLoop, generation);
+}
+
+static void stopNotifier() {
+    {
+        std::lock_guard<std::mutex> lock(g_recorder.notifierMutex);
+        g_recorder.notifierRunning = false;
+    }
+    g_recorder.notifierCondition.notify_all();
+    if (!g_recorder.notifierThread.joinable()) {
+        return;
+    }
+
+    if (g_recorder.notifierThread.get_id() == std::this_thread::get_id()) {
+        // Called from a Java callback on the notifier thread, which cannot join itself; it exits once the callback
+        // returns, without touching the recorder again
+        g_recorder.notifierGeneration.fetch_add(1, std::memory_order_acq_rel);
+        g_recorder.notifierThread.detach();
+    } else {
+        g_recorder.notifierThread.join();
+    }
+}
+
 // Generate recording filename or use configured full path
 static std::string getRecordingFilePath() {
     // If outputPath is already a complete file path (ending with .wav), use it directly
@@ -116,10 +441,23 @@ audioCallback(AAudioStream* stream, void* userData, void* audioData, int32_t num
         return AAUDIO_CALLBACK_RESULT_STOP;
     }
 
+    if (g_recorder.storageStopRequested.load(std::memory_order_acquire)) {
+        g_recorder.isRecording.store(false, std::memory_order_release);
+        g_recorder.stopReason.store(static_cast<int32_t>(StopReason::STORAGE_FULL), std::memory_order_release);
+        return AAUDIO_CALLBACK_RESULT_STOP;
+    }
+
+    // Switch to the segment prepared by the notifier thread, which also closes the old one
+    WavFileWriter* nextWriter = g_recorder.nextWavWriter.exchange(nullptr, std::memory_order_acq_rel);
+    if (nextWriter != nullptr) {
+        g_recorder.retiredWavWriter.store(g_recorder.wavWriter.release(), std::memory_order_release);
+        g_recorder.wavWriter.reset(nextWriter);
+    }
+
     if (!g_recorder.wavWriter || !g_recorder.wavWriter->isOpen()) {
         LOGE("WAV writer not available");
         g_recorder.isRecording.store(false, std::memory_order_release);
-        notifyRecordingError("WAV file writer not opened");
+        g_recorder.stopReason.store(static_cast<int32_t>(StopReason::WRITER_UNAVAILABLE), std::memory_order_release);
         return AAUDIO_CALLBACK_RESULT_STOP;
     }
 
@@ -151,7 +489,7 @@ audioCallback(AAudioStream* stream, void* userData, void* audioData, int32_t num
     if (!g_recorder.wavWriter->writeData(audioData, static_cast<size_t>(bytesToWrite))) {
         LOGE("Failed to write audio data to WAV file");
         g_recorder.isRecording.store(false, std::memory_order_release);
-        notifyRecordingError("Failed to write audio data");
+        g_recorder.stopReason.store(static_cast<int32_t>(StopReason::WRITE_FAILED), std::memory_order_release);
         return AAUDIO_CALLBACK_RESULT_STOP;
     }
 
@@ -163,10 +501,9 @@ static void errorCallback(AAudioStream* stream, void* userData, aaudio_result_t
     LOGE("AAudio error callback: %s", AAudio_convertResultToText(error));
     g_recorder.isRecording.store(false, std::memory_order_release);
 
-    // Build error message
-    std::string errorMsg = "Recording stream error: ";
-    errorMsg += AAudio_convertResultToText(error);
-    notifyRecordingError(errorMsg);
+    // Error callback runs on an AAudio thread not attached to the JVM, report through the notifier
+    g_recorder.streamError.store(error, std::memory_order_release);
+    g_recorder.stopReason.store(static_cast<int32_t>(StopReason::STREAM_ERROR), std::memory_order_release);
 }
 
 // Create AAudio stream
@@ -244,9 +581,10 @@ JNIEXPORT jboolean JNICALL Java_com_example_aaudiorecorder_recorder_AAudioRecord
     g_recorder.onRecordingStartedMethod = env->GetMethodID(clazz, "onNativeRecordingStarted", "()V");
     g_recorder.onRecordingStoppedMethod = env->GetMethodID(clazz, "onNativeRecordingStopped", "()V");
     g_recorder.onRecordingErrorMethod = env->GetMethodID(clazz, "onNativeRecordingError", "(Ljava/lang/String;)V");
+    g_recorder.onStorageStateChangedMethod = env->GetMethodID(clazz, "onNativeStorageStateChanged", "(IIJJ)V");
 
     if (!g_recorder.onRecordingStartedMethod || !g_recorder.onRecordingStoppedMethod ||
-        !g_recorder.onRecordingErrorMethod) {
+        !g_recorder.onRecordingErrorMethod || !g_recorder.onStorageStateChangedMethod) {
         LOGE("Failed to get callback method IDs");
         return JNI_FALSE;
     }
@@ -291,6 +629,48 @@ JNIEXPORT jboolean JNICALL Java_com_example_aaudiorecorder_recorder_AAudioRecord
     return JNI_TRUE;
 }
 
+JNIEXPORT jboolean JNICALL Java_com_example_aaudiorecorder_recorder_AAudioRecorder_setNativeStorageConfig(
+    JNIEnv* env, jobject thiz, jint lowSpaceSeconds, jint criticalSeconds, jint storageAction, jstring fallbackDir) {
+    if (fallbackDir == nullptr) {
+        LOGE("Fallback directory is null");
+        return JNI_FALSE;
+    }
+
+    if (criticalSeconds <= 0 || lowSpaceSeconds < criticalSeconds) {
+        LOGE("Invalid storage thresholds - low: %d, critical: %d", lowSpaceSeconds, criticalSeconds);
+        return JNI_FALSE;
+    }
+
+    if (storageAction < static_cast<jint>(StorageAction::NONE) ||
+        storageAction > static_cast<jint>(StorageAction::ROTATE_DIRECTORY)) {
+        LOGE("Invalid storage action: %d", storageAction);
+        return JNI_FALSE;
+    }
+
+    g_recorder.lowSpaceSeconds = lowSpaceSeconds;
+    g_recorder.criticalSeconds = criticalSeconds;
+    g_recorder.storageAction = static_cast<StorageAction>(storageAction);
+
+    const char* dirStr = env->GetStringUTFChars(fallbackDir, nullptr);
+    if (dirStr != nullptr) {
+        g_recorder.fallbackDir = dirStr;
+        env->ReleaseStringUTFChars(fallbackDir, dirStr);
+
+        // Strip trailing slashes, segment file paths add their own
+        while (g_recorder.fallbackDir.length() > 1 && g_recorder.fallbackDir.back() == '/') {
+            g_recorder.fallbackDir.pop_back();
+        }
+    } else {
+        LOGE("Failed to get fallback directory string");
+        return JNI_FALSE;
+    }
+
+    LOGI("Storage config updated - Low: %ds, Critical: %ds, Action: %d, Fallback: %s", lowSpaceSeconds,
+         criticalSeconds, storageAction, g_recorder.fallbackDir.c_str());
+
+    return JNI_TRUE;
+}
+
 JNIEXPORT jboolean JNICALL Java_com_example_aaudiorecorder_recorder_AAudioRecorder_startNativeRecording(JNIEnv* env,
                                                                                                         jobject thiz) {
     if (g_recorder.isRecording.load()) {
@@ -300,6 +680,10 @@ JNIEXPORT jboolean JNICALL Java_com_example_aaudiorecorder_recorder_AAudioRecord
 
     LOGI("Starting recording");
 
+    // Join notifier and release anything left over from a recording stopped by a callback
+    stopNotifier();
+    closeRecordingResources();
+
     // Create AAudio stream
     if (!createAAudioStream()) {
         notifyRecordingError("Failed to create recording stream");
@@ -312,16 +696,32 @@ JNIEXPORT jboolean JNICALL Java_com_example_aaudiorecorder_recorder_AAudioRecord
 
     if (!g_recorder.wavWriter->open(filePath, g_recorder.sampleRate, g_recorder.channelCount, g_recorder.format)) {
         LOGE("Failed to open WAV file: %s", filePath.c_str());
+        closeRecordingResources();
         notifyRecordingError("Failed to create recording file");
         return JNI_FALSE;
     }
 
+    // Reset storage monitoring for the new recording
+    g_recorder.storageMonitor.setThresholds(g_recorder.lowSpaceSeconds, g_recorder.criticalSeconds);
+    g_recorder.storageMonitor.reset(filePath, getDataBytesPerSecond(g_recorder.format));
+    g_recorder.wavWriter->setStorageMonitor(&g_recorder.storageMonitor);
+    g_recorder.storageState = StorageState::NORMAL;
+    g_recorder.segmentBaseName = getSegmentBaseName(filePath);
+    g_recorder.segmentIndex = 0;
+    g_recorder.segmentFilePath = filePath;
+    g_recorder.segmentFormat = g_recorder.format;
+    g_recorder.maxFramesPerWrite = std::max(AAudioStream_getFramesPerBurst(g_recorder.stream),
+                                            AAudioStream_getBufferCapacityInFrames(g_recorder.stream));
+
+    // Start notifier before the stream so events from the first callbacks are delivered
+    startNotifier();
+
     // Start recording stream
     aaudio_result_t result = AAudioStream_requestStart(g_recorder.stream);
     if (result != AAUDIO_OK) {
         LOGE("Failed to start recording stream: %s", AAudio_convertResultToText(result));
-        g_recorder.wavWriter->close();
-        g_recorder.wavWriter.reset();
+        stopNotifier();
+        closeRecordingResources();
         notifyRecordingError("Failed to start recording stream");
         return JNI_FALSE;
     }
@@ -336,38 +736,26 @@ JNIEXPORT jboolean JNICALL Java_com_example_aaudiorecorder_recorder_AAudioRecord
 
 JNIEXPORT jboolean JNICALL Java_com_example_aaudiorecorder_recorder_AAudioRecorder_stopNativeRecording(JNIEnv* env,
                                                                                                        jobject thiz) {
-    if (!g_recorder.isRecording.load(std::memory_order_acquire)) {
+    // First set stop flag
+    bool wasRecording = g_recorder.isRecording.exchange(false, std::memory_order_acq_rel);
+
+    // Join notifier before touching the stream, it may be tearing down a recording stopped by a callback
+    stopNotifier();
+
+    // A recording stopped by a callback may still hold its stream and file
+    if (!wasRecording && g_recorder.stream == nullptr && !g_recorder.wavWriter) {
         LOGW("Not recording");
         return JNI_FALSE;
     }
 
     LOGI("Stopping recording");
 
-    // First set stop flag
-    g_recorder.isRecording.store(false, std::memory_order_release);
-
     // Wait a short time for callback function to complete
-    std::this_thread::sleep_for(std::chrono::milliseconds(50));
-
-    // Stop recording stream
-    if (g_recorder.stream) {
-        aaudio_result_t result = AAudioStream_requestStop(g_recorder.stream);
-        if (result != AAUDIO_OK) {
-            LOGW("Failed to stop stream: %s", AAudio_convertResultToText(result));
-        }
-
-        result = AAudioStream_close(g_recorder.stream);
-        if (result != AAUDIO_OK) {
-            LOGW("Failed to close stream: %s", AAudio_convertResultToText(result));
-        }
-        g_recorder.stream = nullptr;
+    if (wasRecording) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
     }
 
-    // Close WAV file
-    if (g_recorder.wavWriter) {
-        g_recorder.wavWriter->close();
-        g_recorder.wavWriter.reset();
-    }
+    closeRecordingResources();
 
     LOGI("Recording stopped successfully");
 
@@ -384,6 +772,8 @@ JNIEXPORT void JNICALL Java_com_example_aaudiorecorder_recorder_AAudioRecorder_r
     if (g_recorder.isRecording.load()) {
         Java_com_example_aaudiorecorder_recorder_AAudioRecorder_stopNativeRecording(env, thiz);
     }
+    stopNotifier();
+    closeRecordingResources();
 
     // Clean up Java references
     if (g_recorder.recorderInstance) {
@@ -395,29 +785,149 @@ JNIEXPORT void JNICALL Java_com_example_aaudiorecorder_recorder_AAudioRecorder_r
     g_recorder.onRecordingStartedMethod = nullptr;
     g_recorder.onRecordingStoppedMethod = nullptr;
     g_recorder.onRecordingErrorMethod = nullptr;
+    g_recorder.onStorageStateChangedMethod = nullptr;
 
     LOGI("AAudio recorder released");
 }
 
 } // extern "C"
 
+// StorageMonitor class implementation
+StorageMonitor::StorageMonitor()
+    : mDataBytesPerSecond(0), mWriteNanosPerByte(0), mPendingBytes(0), mPendingNanos(0), mFileBytes(0),
+      mLowSpaceSeconds(60), mCriticalSeconds(10) {}
+
+void StorageMonitor::reset(const std::string& filePath, double dataBytesPerSecond) {
+    // Resolve relative paths now, so free space is queried for the filesystem the file lives on
+    mDirectory = resolveDirectory(getDirectory(filePath));
+    mDataBytesPerSecond = dataBytesPerSecond;
+    mWriteNanosPerByte = 0;
+    mPendingBytes.store(0, std::memory_order_relaxed);
+    mPendingNanos.store(0, std::memory_order_relaxed);
+    mFileBytes.store(0, std::memory_order_relaxed);
+    mLastPoll = std::chrono::steady_clock::now();
+}
+
+void StorageMonitor::setThresholds(int32_t lowSpaceSeconds, int32_t criticalSeconds) {
+    mLowSpaceSeconds = lowSpaceSeconds;
+    mCriticalSeconds = criticalSeconds;
+}
+
+void StorageMonitor::recordWrite(size_t bytes, std::chrono::nanoseconds elapsed) {
+    mPendingBytes.fetch_add(bytes, std::memory_order_relaxed);
+    mPendingNanos.fetch_add(elapsed.count(), std::memory_order_relaxed);
+    mFileBytes.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+uint64_t StorageMonitor::getFileBytes() const { return mFileBytes.load(std::memory_order_relaxed); }
+
+bool StorageMonitor::poll(uint64_t maxFileBytes, StorageStatus& status) {
+    auto now = std::chrono::steady_clock::now();
+    if (now - mLastPoll < POLL_INTERVAL) {
+        return false;
+    }
+    mLastPoll = now;
+
+    // Smooth time spent per byte rather than rate, so buffered bursts do not hide a slow device
+    uint64_t pendingBytes = mPendingBytes.exchange(0, std::memory_order_relaxed);
+    int64_t pendingNanos = mPendingNanos.exchange(0, std::memory_order_relaxed);
+    if (pendingBytes > 0 && pendingNanos > 0) {
+        double nanosPerByte = static_cast<double>(pendingNanos) / static_cast<double>(pendingBytes);
+        mWriteNanosPerByte = (mWriteNanosPerByte == 0)
+                                 ? nanosPerByte
+                                 : mWriteNanosPerByte + THROUGHPUT_SMOOTHING * (nanosPerByte - mWriteNanosPerByte);
+    }
+    double writeBytesPerSecond = (mWriteNanosPerByte > 0) ? 1e9 / mWriteNanosPerByte : 0;
+
+    // WAV data size is 32-bit, so the file limit counts as well as free space
+    uint64_t freeBytes = 0;
+    bool spaceKnown = queryFreeBytes(mDirectory, freeBytes);
+    status.freeBytes = spaceKnown ? std::min(freeBytes, maxFileBytes) : 0;
+    status.writeBytesPerSecond = writeBytesPerSecond;
+    status.secondsToFull = (spaceKnown && mDataBytesPerSecond > 0)
+                               ? static_cast<int64_t>(static_cast<double>(status.freeBytes) / mDataBytesPerSecond)
+                               : -1;
+
+    if (status.secondsToFull >= 0 && status.secondsToFull < mCriticalSeconds) {
+        status.state = StorageState::CRITICAL;
+    } else if (status.secondsToFull >= 0 && status.secondsToFull < mLowSpaceSeconds) {
+        status.state = StorageState::LOW_SPACE;
+    } else if (writeBytesPerSecond > 0 && writeBytesPerSecond < mDataBytesPerSecond) {
+        status.state = StorageState::SLOW;
+    } else {
+        status.state = StorageState::NORMAL;
+    }
+    return true;
+}
+
+bool StorageMonitor::queryFreeBytes(const std::string& directory, uint64_t& freeBytes) {
+    struct statvfs fsInfo = {};
+    if (statvfs(directory.c_str(), &fsInfo) != 0) {
+        LOGW("Failed to query free space: %s", directory.c_str());
+        return false;
+    }
+    freeBytes = static_cast<uint64_t>(fsInfo.f_bavail) * static_cast<uint64_t>(fsInfo.f_frsize);
+    return true;
+}
+
+bool StorageMonitor::isSameFilesystem(const std::string& first, const std::string& second) {
+    struct statvfs firstFs = {};
+    struct statvfs secondFs = {};
+    struct stat firstStat = {};
+    struct stat secondStat = {};
+    if (statvfs(first.c_str(), &firstFs) != 0 || statvfs(second.c_str(), &secondFs) != 0 ||
+        stat(first.c_str(), &firstStat) != 0 || stat(second.c_str(), &secondStat) != 0) {
+        return false;
+    }
+
+    // Some filesystems report no filesystem ID, the device then tells them apart
+    if (firstFs.f_fsid != 0 && secondFs.f_fsid != 0) {
+        return firstFs.f_fsid == secondFs.f_fsid;
+    }
+    return firstStat.st_dev == secondStat.st_dev;
+}
+
+std::string StorageMonitor::resolveDirectory(const std::string& directory) {
+    char resolved[PATH_MAX];
+    if (realpath(directory.c_str(), resolved) == nullptr) {
+        return directory;
+    }
+    return resolved;
+}
+
+std::string StorageMonitor::getDirectory(const std::string& filePath) {
+    size_t pos = filePath.find_last_of('/');
+    if (pos == std::string::npos) {
+        return ".";
+    }
+    return (pos == 0) ? "/" : filePath.substr(0, pos);
+}
+
 // WavFileWriter class implementation
-WavFileWriter::WavFileWriter() : mSampleRate(0), mChannelCount(0), mFormat(AAUDIO_FORMAT_PCM_I16), mDataSize(0) {}
+WavFileWriter::WavFileWriter()
+    : mSampleRate(0), mChannelCount(0), mFormat(AAUDIO_FORMAT_PCM_I16), mStorageFormat(AAUDIO_FORMAT_PCM_I16),
+      mDataSize(0), mMaxSamplesPerWrite(0), mStorageMonitor(nullptr) {}
 
 WavFileWriter::~WavFileWriter() { close(); }
 
 bool WavFileWriter::open(const std::string& filePath,
                          int32_t sampleRate,
                          int32_t channelCount,
-                         aaudio_format_t format) {
+                         aaudio_format_t format,
+                         aaudio_format_t storageFormat) {
     close(); // Ensure previous file is closed
 
-    mFilePath = filePath;
     mSampleRate = sampleRate;
     mChannelCount = channelCount;
     mFormat = format;
+
+    // Only 16-bit conversion is supported besides storing data as-is
+    mStorageFormat = (storageFormat == AAUDIO_FORMAT_PCM_I16) ? AAUDIO_FORMAT_PCM_I16 : format;
+
+    mFilePath = filePath;
     mDataSize = 0;
 
+    mFileStream.clear();
     mFileStream.open(filePath, std::ios::binary | std::ios::out);
     if (!mFileStream.is_open()) {
         LOGE("Failed to open WAV file for writing: %s", filePath.c_str());
@@ -431,9 +941,22 @@ bool WavFileWriter::open(const std::string& filePath,
     return true;
 }
 
+void WavFileWriter::setMaxFramesPerWrite(int32_t frames) {
+    mMaxSamplesPerWrite = static_cast<size_t>(std::max(frames, 0)) * static_cast<size_t>(mChannelCount);
+
+    // Allocate the conversion buffer here rather than in the data callback
+    if (mStorageFormat != mFormat && mConvertBuffer.size() < mMaxSamplesPerWrite) {
+        mConvertBuffer.resize(mMaxSamplesPerWrite);
+    }
+}
+
 void WavFileWriter::close() {
     if (mFileStream.is_open()) {
-        // Update data size in WAV header
+        // Clear error state left by a failed write so the header still gets updated
+        mFileStream.clear();
+
+        // Update data size in WAV header (not possible for non-seekable sinks such as pipes)
+        mFileStream.seekp(0, std::ios::beg);
         writeHeader(mDataSize);
         mFileStream.close();
         LOGI("WAV file closed: %s, final size: %u bytes", mFilePath.c_str(), mDataSize);
@@ -445,11 +968,20 @@ bool WavFileWriter::writeData(const void* data, size_t size) {
         return false;
     }
 
+    if (mStorageFormat != mFormat) {
+        size = convertToI16(data, size);
+        data = mConvertBuffer.data();
+    }
+
+    auto writeStart = std::chrono::steady_clock::now();
     mFileStream.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
     if (mFileStream.fail()) {
         LOGE("Failed to write data to WAV file");
         return false;
     }
+    if (mStorageMonitor) {
+        mStorageMonitor->recordWrite(size, std::chrono::steady_clock::now() - writeStart);
+    }
 
     mDataSize += static_cast<uint32_t>(size);
     return true;
@@ -457,6 +989,49 @@ bool WavFileWriter::writeData(const void* data, size_t size) {
 
 bool WavFileWriter::isOpen() const { return mFileStream.is_open(); }
 
+const std::string& WavFileWriter::getFilePath() const { return mFilePath; }
+
+aaudio_format_t WavFileWriter::getStorageFormat() const { return mStorageFormat; }
+
+void WavFileWriter::setStorageMonitor(StorageMonitor* monitor) { mStorageMonitor = monitor; }
+
+size_t WavFileWriter::convertToI16(const void* data, size_t size) {
+    size_t sampleCount = size / static_cast<size_t>(getBytesPerSample(mFormat));
+    if (mConvertBuffer.size() < sampleCount) {
+        // Only when a callback delivers more than setMaxFramesPerWrite() announced
+        LOGW("Conversion buffer too small for %zu samples", sampleCount);
+        mConvertBuffer.resize(sampleCount);
+    }
+
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < sampleCount; i++) {
+        switch (mFormat) {
+        case AAUDIO_FORMAT_PCM_FLOAT: {
+            float sample;
+            memcpy(&sample, bytes + i * 4, sizeof(sample));
+            sample = std::max(-1.0f, std::min(1.0f, sample));
+            mConvertBuffer[i] = static_cast<int16_t>(sample * 32767.0f);
+            break;
+        }
+        case AAUDIO_FORMAT_PCM_I24_PACKED:
+            // Little-endian 24-bit, keep the two most significant bytes
+            mConvertBuffer[i] = static_cast<int16_t>(bytes[i * 3 + 1] | (bytes[i * 3 + 2] << 8));
+            break;
+        case AAUDIO_FORMAT_PCM_I32: {
+            int32_t sample;
+            memcpy(&sample, bytes + i * 4, sizeof(sample));
+            mConvertBuffer[i] = static_cast<int16_t>(sample >> 16);
+            break;
+        }
+        default:
+            memcpy(&mConvertBuffer[i], bytes + i * 2, sizeof(int16_t));
+            break;
+        }
+    }
+
+    return sampleCount * sizeof(int16_t);
+}
+
 int32_t WavFileWriter::getBytesPerSample(aaudio_format_t format) {
     switch (format) {
     case AAUDIO_FORMAT_PCM_I16:
@@ -472,6 +1047,8 @@ int32_t WavFileWriter::getBytesPerSample(aaudio_format_t format) {
     }
 }
 
+uint64_t WavFileWriter::getMaxDataSize() { return UINT32_MAX - sizeof(WAVHeader); }
+
 void WavFileWriter::writeHeader(uint32_t dataSize) {
     if (!mFileStream.is_open()) {
         return;
@@ -489,7 +1066,7 @@ void WavFileWriter::writeHeader(uint32_t dataSize) {
     header.subchunk1Size = 16;
 
     // Set audioFormat based on format
-    if (mFormat == AAUDIO_FORMAT_PCM_FLOAT) {
+    if (mStorageFormat == AAUDIO_FORMAT_PCM_FLOAT) {
         header.audioFormat = 3; // IEEE float
     } else {
         header.audioFormat = 1; // PCM
@@ -497,16 +1074,15 @@ void WavFileWriter::writeHeader(uint32_t dataSize) {
 
     header.numChannels = static_cast<uint16_t>(mChannelCount);
     header.sampleRate = static_cast<uint32_t>(mSampleRate);
-    header.bitsPerSample = static_cast<uint16_t>(getBytesPerSample(mFormat) * 8);
-    header.blockAlign = static_cast<uint16_t>(mChannelCount * getBytesPerSample(mFormat));
+    header.bitsPerSample = static_cast<uint16_t>(getBytesPerSample(mStorageFormat) * 8);
+    header.blockAlign = static_cast<uint16_t>(mChannelCount * getBytesPerSample(mStorageFormat));
     header.byteRate = header.sampleRate * header.blockAlign;
 
     // data subchunk
     memcpy(header.subchunk2Id, "data", 4);
     header.subchunk2Size = dataSize;
 
-    // Write header
-    mFileStream.seekp(0, std::ios::beg);
+    // Write header at current position, the start of the file
     mFileStream.write(reinterpret_cast<const char*>(&header), sizeof(header));
     mFileStream.flush();
 }
\ No newline at end of file
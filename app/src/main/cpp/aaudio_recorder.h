@@ -2,6 +2,8 @@
 #ifndef AAUDIO_RECORDER_H
 #define AAUDIO_RECORDER_H
 
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <fstream>
 #include <jni.h>
@@ -64,6 +66,19 @@ JNIEXPORT jboolean JNICALL Java_com_example_aaudiorecorder_recorder_AAudioRecord
                                                                                                    jint sharingMode,
                                                                                                    jstring outputPath);
 
+/**
+ * Set native storage monitoring configuration
+ * @param env JNI environment
+ * @param thiz Java object instance
+ * @param lowSpaceSeconds Predicted time-to-full (seconds) below which low space is reported
+ * @param criticalSeconds Predicted time-to-full (seconds) below which the storage action is taken
+ * @param storageAction Action taken when storage becomes critical (see StorageAction)
+ * @param fallbackDir Directory used by the rotate action, may be empty
+ * @return JNI_TRUE if configuration set successfully, JNI_FALSE otherwise
+ */
+JNIEXPORT jboolean JNICALL Java_com_example_aaudiorecorder_recorder_AAudioRecorder_setNativeStorageConfig(
+    JNIEnv* env, jobject thiz, jint lowSpaceSeconds, jint criticalSeconds, jint storageAction, jstring fallbackDir);
+
 /**
  * Start audio recording
  * @param env JNI environment
@@ -92,6 +107,81 @@ JNIEXPORT void JNICALL Java_com_example_aaudiorecorder_recorder_AAudioRecorder_r
 #ifdef __cplusplus
 }
 
+// Storage health reported to Java (values match AAudioConstants.Storage)
+enum class StorageState : int32_t {
+    NORMAL = 0,    // Enough space and throughput
+    SLOW = 1,      // Storage accepts data slower than it is produced
+    LOW_SPACE = 2, // Predicted time-to-full below low space threshold
+    CRITICAL = 3,  // Predicted time-to-full below critical threshold
+};
+
+// Action taken when storage becomes critical (values match AAudioConstants.Storage)
+enum class StorageAction : int32_t {
+    NONE = 0,             // Report only, keep writing until a write fails
+    STOP = 1,             // Finalize the WAV file and stop recording
+    DOWNGRADE_FORMAT = 2, // Continue in a new 16-bit segment file
+    ROTATE_DIRECTORY = 3, // Continue in a new segment file in the fallback directory
+};
+
+// Snapshot of storage health
+struct StorageStatus {
+    StorageState state = StorageState::NORMAL;
+    uint64_t freeBytes = 0;         // Bytes still writable to the current file, 0 if unknown
+    int64_t secondsToFull = -1;     // Predicted time-to-full, -1 if unknown
+    double writeBytesPerSecond = 0; // Smoothed throughput observed while writing
+};
+
+/**
+ * Storage monitor for the recording file
+ * Tracks write throughput and free space, and predicts time-to-full
+ * Writes are recorded from the data callback, everything else runs on the notifier thread
+ */
+class StorageMonitor {
+public:
+    StorageMonitor();
+
+    // Reset statistics for a new file; dataBytesPerSecond is the rate audio is produced at
+    void reset(const std::string& filePath, double dataBytesPerSecond);
+
+    // Set time-to-full thresholds in seconds
+    void setThresholds(int32_t lowSpaceSeconds, int32_t criticalSeconds);
+
+    // Record a completed write and the time spent in it (lock-free, safe in the data callback)
+    void recordWrite(size_t bytes, std::chrono::nanoseconds elapsed);
+
+    // Get bytes written to the current file
+    uint64_t getFileBytes() const;
+
+    // Sample storage at most once per poll interval, returns true if status was updated
+    bool poll(uint64_t maxFileBytes, StorageStatus& status);
+
+    // Get free bytes available to unprivileged writers in directory, returns false on failure
+    static bool queryFreeBytes(const std::string& directory, uint64_t& freeBytes);
+
+    // Get whether two directories are on the same filesystem, returns false if either cannot be queried
+    static bool isSameFilesystem(const std::string& first, const std::string& second);
+
+    // Resolve directory to an absolute path without symlinks, returned unchanged if that fails
+    static std::string resolveDirectory(const std::string& directory);
+
+    // Get the directory part of a file path
+    static std::string getDirectory(const std::string& filePath);
+
+private:
+    static constexpr std::chrono::milliseconds POLL_INTERVAL{500};
+    static constexpr double THROUGHPUT_SMOOTHING = 0.3;
+
+    std::string mDirectory;                          // Absolute directory being monitored
+    double mDataBytesPerSecond;                      // Audio data rate
+    double mWriteNanosPerByte;                       // Smoothed write time per byte
+    std::atomic<uint64_t> mPendingBytes;             // Bytes written since last poll
+    std::atomic<int64_t> mPendingNanos;              // Time spent writing since last poll
+    std::atomic<uint64_t> mFileBytes;                // Bytes written to the current file
+    std::chrono::steady_clock::time_point mLastPoll; // Time of last poll
+    int32_t mLowSpaceSeconds;                        // Low space threshold
+    int32_t mCriticalSeconds;                        // Critical threshold
+};
+
 /**
  * WAV file writing class (for recording)
  * Supports WAV file writing and audio data saving
@@ -101,21 +191,40 @@ public:
     WavFileWriter();
     ~WavFileWriter();
 
-    // Open WAV file for writing with specified parameters
-    bool open(const std::string& filePath, int32_t sampleRate, int32_t channelCount, aaudio_format_t format);
+    // Open WAV file for writing with specified parameters, storing samples as 16-bit or as received
+    bool open(const std::string& filePath,
+              int32_t sampleRate,
+              int32_t channelCount,
+              aaudio_format_t format,
+              aaudio_format_t storageFormat = AAUDIO_FORMAT_UNSPECIFIED);
 
     // Close WAV file
     void close();
 
-    // Write audio data
+    // Set largest write in frames, so format conversion does not allocate while writing
+    void setMaxFramesPerWrite(int32_t frames);
+
+    // Write audio data, converting to storage format if needed
     bool writeData(const void* data, size_t size);
 
     // Get whether file is open
     bool isOpen() const;
 
+    // Get current file path
+    const std::string& getFilePath() const;
+
+    // Get format samples are stored in
+    aaudio_format_t getStorageFormat() const;
+
+    // Set monitor notified of every write, may be null
+    void setStorageMonitor(StorageMonitor* monitor);
+
     // Get bytes per sample
     static int32_t getBytesPerSample(aaudio_format_t format);
 
+    // Get largest data size a WAV file can hold
+    static uint64_t getMaxDataSize();
+
 private:
     // WAV file header definition
     struct WAVHeader {
@@ -134,12 +243,19 @@ private:
         [[maybe_unused]] uint32_t subchunk2Size; // numSamples * numChannels * bitsPerSample / 8
     };
 
-    std::string mFilePath;     // File path
-    std::ofstream mFileStream; // File stream
-    int32_t mSampleRate;       // Sample rate
-    int32_t mChannelCount;     // Channel count
-    aaudio_format_t mFormat;   // Audio format
-    uint32_t mDataSize;        // Data size
+    std::string mFilePath;               // File path
+    std::ofstream mFileStream;           // File stream
+    int32_t mSampleRate;                 // Sample rate
+    int32_t mChannelCount;               // Channel count
+    aaudio_format_t mFormat;             // Audio format of incoming data
+    aaudio_format_t mStorageFormat;      // Audio format written to file
+    uint32_t mDataSize;                  // Data size
+    std::vector<int16_t> mConvertBuffer; // Buffer for format conversion
+    size_t mMaxSamplesPerWrite;          // Largest expected write in samples
+    StorageMonitor* mStorageMonitor;     // Storage monitor, not owned
+
+    // Convert incoming data to 16-bit PCM, returns converted size in bytes
+    size_t convertToI16(const void* data, size_t size);
 
     // Write WAV file header
     void writeHeader(uint32_t dataSize);
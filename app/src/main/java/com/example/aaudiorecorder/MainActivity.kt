@@ -16,6 +16,7 @@ import android.widget.Toast
 import androidx.appcompat.app.AppCompatActivity
 import androidx.core.app.ActivityCompat
 import androidx.core.content.ContextCompat
+import com.example.aaudiorecorder.common.AAudioConstants
 import com.example.aaudiorecorder.config.AAudioConfig
 import com.example.aaudiorecorder.recorder.AAudioRecorder
 
@@ -109,6 +110,23 @@ class MainActivity : AppCompatActivity() {
                     Toast.makeText(this@MainActivity, "Error: $error", Toast.LENGTH_SHORT).show()
                 }
             }
+            
+            @SuppressLint("SetTextI18n")
+            override fun onStorageStateChanged(state: Int, action: Int, freeBytes: Long, secondsToFull: Long) {
+                val message = when (action) {
+                    AAudioConstants.Storage.ACTION_DOWNGRADE_FORMAT -> "Storage low, continuing in 16-bit"
+                    AAudioConstants.Storage.ACTION_ROTATE_DIRECTORY -> "Storage low, continuing in fallback directory"
+                    else -> when (state) {
+                        AAudioConstants.Storage.STATE_SLOW -> "Storage too slow for recording"
+                        AAudioConstants.Storage.STATE_LOW_SPACE -> "Storage low: ${secondsToFull}s left"
+                        AAudioConstants.Storage.STATE_CRITICAL -> "Storage critical: ${secondsToFull}s left"
+                        else -> "Recording in progress"
+                    }
+                }
+                runOnUiThread {
+                    statusText.text = message
+                }
+            }
         })
     }
 
@@ -24,6 +24,11 @@ object AAudioConstants {
     // Default audio file paths
     const val DEFAULT_RECORD_FILE = "/data/recorded_48k_1ch_16bit.wav"
     
+    // Storage monitoring defaults (predicted time-to-full in seconds)
+    const val DEFAULT_LOW_SPACE_SECONDS = 60
+    const val DEFAULT_CRITICAL_SECONDS = 10
+    const val DEFAULT_STORAGE_ACTION = "STORAGE_ACTION_STOP"
+    
     /**
      * AAudio native constants (matching NDK definitions)
      */
@@ -53,6 +58,23 @@ object AAudioConstants {
         const val SHARING_MODE_SHARED = 1
     }
     
+    /**
+     * Storage constants (matching native StorageState and StorageAction)
+     */
+    object Storage {
+        // Storage state values
+        const val STATE_NORMAL = 0
+        const val STATE_SLOW = 1
+        const val STATE_LOW_SPACE = 2
+        const val STATE_CRITICAL = 3
+        
+        // Storage action values
+        const val ACTION_NONE = 0
+        const val ACTION_STOP = 1
+        const val ACTION_DOWNGRADE_FORMAT = 2
+        const val ACTION_ROTATE_DIRECTORY = 3
+    }
+    
     /**
      * Input preset constants mapping
      */
@@ -90,6 +112,18 @@ object AAudioConstants {
         )
     }
 
+    /**
+     * Storage action constants mapping
+     */
+    object StorageAction {
+        val MAP = mapOf(
+            Storage.ACTION_NONE to "STORAGE_ACTION_NONE",
+            Storage.ACTION_STOP to "STORAGE_ACTION_STOP",
+            Storage.ACTION_DOWNGRADE_FORMAT to "STORAGE_ACTION_DOWNGRADE_FORMAT",
+            Storage.ACTION_ROTATE_DIRECTORY to "STORAGE_ACTION_ROTATE_DIRECTORY"
+        )
+    }
+
     /**
      * Get format integer value from bit depth
      */
@@ -131,6 +165,12 @@ object AAudioConstants {
     fun getSharingMode(sharingMode: String): Int =
         parseEnumValue(SharingMode.MAP, sharingMode, AAudio.SHARING_MODE_SHARED, "SharingMode")
     
+    /**
+     * Get storage action integer value
+     */
+    fun getStorageAction(storageAction: String): Int =
+        parseEnumValue(StorageAction.MAP, storageAction, Storage.ACTION_STOP, "StorageAction")
+    
     /**
      * Validate sample rate
      */
@@ -17,7 +17,11 @@ data class AAudioConfig(
     val performanceMode: String = "AAUDIO_PERFORMANCE_MODE_LOW_LATENCY",
     val sharingMode: String = "AAUDIO_SHARING_MODE_SHARED",
     val outputPath: String = AAudioConstants.DEFAULT_RECORD_FILE,
-    val description: String = "Default Recording Configuration"
+    val description: String = "Default Recording Configuration",
+    val lowSpaceSeconds: Int = AAudioConstants.DEFAULT_LOW_SPACE_SECONDS,
+    val criticalSeconds: Int = AAudioConstants.DEFAULT_CRITICAL_SECONDS,
+    val storageAction: String = AAudioConstants.DEFAULT_STORAGE_ACTION,
+    val fallbackDir: String = ""
 ) {
     
     init {
@@ -31,6 +35,9 @@ data class AAudioConfig(
         require(AAudioConstants.isValidFormat(format)) { 
             "Invalid format bit depth: $format (must be 16, 24, or 32)" 
         }
+        require(criticalSeconds > 0 && lowSpaceSeconds >= criticalSeconds) {
+            "Invalid storage thresholds: low $lowSpaceSeconds s, critical $criticalSeconds s"
+        }
     }
     
     companion object {
@@ -65,7 +72,11 @@ data class AAudioConfig(
                     performanceMode = config.optString("performanceMode", "AAUDIO_PERFORMANCE_MODE_LOW_LATENCY"),
                     sharingMode = config.optString("sharingMode", "AAUDIO_SHARING_MODE_SHARED"),
                     outputPath = config.optString("outputPath", AAudioConstants.DEFAULT_RECORD_FILE),
-                    description = config.optString("description", "Recording Configuration")
+                    description = config.optString("description", "Recording Configuration"),
+                    lowSpaceSeconds = config.optInt("lowSpaceSeconds", AAudioConstants.DEFAULT_LOW_SPACE_SECONDS),
+                    criticalSeconds = config.optInt("criticalSeconds", AAudioConstants.DEFAULT_CRITICAL_SECONDS),
+                    storageAction = config.optString("storageAction", AAudioConstants.DEFAULT_STORAGE_ACTION),
+                    fallbackDir = config.optString("fallbackDir", "")
                 )
             }
         }
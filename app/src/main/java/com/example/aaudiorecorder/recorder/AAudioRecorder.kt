@@ -25,10 +25,16 @@ class AAudioRecorder {
         fun onRecordingStarted()
         fun onRecordingStopped()
         fun onRecordingError(error: String)
+        
+        /**
+         * Storage state changed or a storage action was taken, see AAudioConstants.Storage
+         */
+        fun onStorageStateChanged(state: Int, action: Int, freeBytes: Long, secondsToFull: Long) {}
     }
     
     private var currentConfig: AAudioConfig = AAudioConfig()
     private var listener: RecordingListener? = null
+    @Volatile
     private var isRecording = false
     
     init {
@@ -61,6 +67,12 @@ class AAudioRecorder {
             AAudioConstants.getSharingMode(currentConfig.sharingMode),
             currentConfig.outputPath
         )
+        setNativeStorageConfig(
+            currentConfig.lowSpaceSeconds,
+            currentConfig.criticalSeconds,
+            AAudioConstants.getStorageAction(currentConfig.storageAction),
+            currentConfig.fallbackDir
+        )
     }
 
     /**
@@ -160,6 +172,12 @@ class AAudioRecorder {
         sharingMode: Int,
         outputPath: String
     ): Boolean
+    private external fun setNativeStorageConfig(
+        lowSpaceSeconds: Int,
+        criticalSeconds: Int,
+        storageAction: Int,
+        fallbackDir: String
+    ): Boolean
     private external fun startNativeRecording(): Boolean
     private external fun stopNativeRecording(): Boolean
     private external fun releaseNative()
@@ -185,4 +203,10 @@ class AAudioRecorder {
         listener?.onRecordingError(error)
         Log.e(TAG, "Recording error: $error")
     }
+    
+    @Suppress("unused")
+    private fun onNativeStorageStateChanged(state: Int, action: Int, freeBytes: Long, secondsToFull: Long) {
+        listener?.onStorageStateChanged(state, action, freeBytes, secondsToFull)
+        Log.w(TAG, "Storage state: $state, action: $action, free: $freeBytes bytes, time to full: $secondsToFull s")
+    }
 }
\ No newline at end of file
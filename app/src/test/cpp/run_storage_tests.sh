@@ -0,0 +1,25 @@
+#!/bin/sh
+# Build and run the native storage tests on the host.
+# As root, mounts size-limited tmpfs for the STOP / DOWNGRADE_FORMAT / ROTATE_DIRECTORY cases;
+# otherwise those cases are skipped and only the unit and throttled sink cases run.
+set -e
+
+SRC_DIR=$(cd "$(dirname "$0")" && pwd)
+BUILD_DIR=${BUILD_DIR:-"$SRC_DIR/build"}
+
+cmake -S "$SRC_DIR" -B "$BUILD_DIR"
+cmake --build "$BUILD_DIR" -j"$(nproc)"
+
+if [ "$(id -u)" -eq 0 ]; then
+    MOUNT_DIR=$(mktemp -d)
+    mkdir -p "$MOUNT_DIR/small" "$MOUNT_DIR/big"
+    mount -t tmpfs -o size=2m tmpfs "$MOUNT_DIR/small"
+    mount -t tmpfs -o size=4m tmpfs "$MOUNT_DIR/big"
+    trap 'umount "$MOUNT_DIR/small" "$MOUNT_DIR/big"; rm -rf "$MOUNT_DIR"' EXIT
+    export SMALL_DIR="$MOUNT_DIR/small"
+    export BIG_DIR="$MOUNT_DIR/big"
+else
+    echo "Not root, size-limited tmpfs cases will be skipped"
+fi
+
+ctest --test-dir "$BUILD_DIR" --output-on-failure
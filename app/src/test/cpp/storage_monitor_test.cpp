@@ -0,0 +1,522 @@
+// Host tests for storage monitoring in the AAudio recorder
+// Built against stub AAudio/JNI headers (see stubs/), run with run_storage_tests.sh
+// Cases needing size-limited filesystems read SMALL_DIR and BIG_DIR and are skipped without them
+#include "aaudio_recorder.cpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Count heap allocations per thread to check the data callback does not allocate
+static thread_local int t_allocations = 0;
+
+// Allocations made by the data callback during the last runCallbacks()
+static int g_callbackAllocations = 0;
+
+void* operator new(size_t size) {
+    t_allocations++;
+    if (void* ptr = malloc(size == 0 ? 1 : size)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept { free(ptr); }
+void operator delete(void* ptr, size_t) noexcept { free(ptr); }
+
+// Exit code reported to CTest for skipped cases
+static constexpr int SKIP = 77;
+
+static int g_failures = 0;
+
+#define CHECK(cond)                                                                                                    \
+    do {                                                                                                               \
+        if (!(cond)) {                                                                                                 \
+            fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #cond);                                   \
+            g_failures++;                                                                                              \
+        }                                                                                                              \
+    } while (0)
+
+static jobject g_thiz = new _jobject();
+
+static jboolean setConfig(int32_t sampleRate, int32_t channelCount, aaudio_format_t format, const std::string& path) {
+    JNIEnv* env = jni_stub::env();
+    jstring pathStr = env->NewStringUTF(path.c_str());
+    jboolean result = Java_com_example_aaudiorecorder_recorder_AAudioRecorder_setNativeConfig(
+        env, g_thiz, AAUDIO_INPUT_PRESET_GENERIC, sampleRate, channelCount, format,
+        AAUDIO_PERFORMANCE_MODE_LOW_LATENCY, AAUDIO_SHARING_MODE_SHARED, pathStr);
+    env->DeleteLocalRef(pathStr);
+    return result;
+}
+
+static jboolean setStorageConfig(int32_t lowSpaceSeconds,
+                                 int32_t criticalSeconds,
+                                 StorageAction action,
+                                 const std::string& fallbackDir) {
+    JNIEnv* env = jni_stub::env();
+    jstring dirStr = env->NewStringUTF(fallbackDir.c_str());
+    jboolean result = Java_com_example_aaudiorecorder_recorder_AAudioRecorder_setNativeStorageConfig(
+        env, g_thiz, lowSpaceSeconds, criticalSeconds, static_cast<jint>(action), dirStr);
+    env->DeleteLocalRef(dirStr);
+    return result;
+}
+
+static jboolean startRecording() {
+    return Java_com_example_aaudiorecorder_recorder_AAudioRecorder_startNativeRecording(jni_stub::env(), g_thiz);
+}
+
+static jboolean stopRecording() {
+    return Java_com_example_aaudiorecorder_recorder_AAudioRecorder_stopNativeRecording(jni_stub::env(), g_thiz);
+}
+
+// Drive the data callback in real time from a thread not attached to the JVM, like AAudio does
+// Returns the number of callbacks until the callback asked to stop, the time limit passed or cancel was set
+static int runCallbacks(double maxSeconds, const std::atomic<bool>& cancel) {
+    AAudioStream* stream = aaudio_stub::lastStream;
+    int32_t framesPerCallback = stream->config.sampleRate / 100;
+    std::vector<uint8_t> buffer(static_cast<size_t>(framesPerCallback) * stream->config.channelCount *
+                                    WavFileWriter::getBytesPerSample(stream->config.format),
+                                0x11);
+
+    int callbacks = 0;
+    std::thread callbackThread([&]() {
+        int allocationsBefore = t_allocations;
+        auto tick = std::chrono::steady_clock::now();
+        auto end = tick + std::chrono::duration<double>(maxSeconds);
+        while (!cancel.load() && tick < end) {
+            callbacks++;
+            if (stream->config.dataCallback(stream, nullptr, buffer.data(), framesPerCallback) !=
+                AAUDIO_CALLBACK_RESULT_CONTINUE) {
+                break;
+            }
+            std::this_thread::sleep_until(tick += std::chrono::milliseconds(10));
+        }
+        g_callbackAllocations = t_allocations - allocationsBefore;
+    });
+    callbackThread.join();
+    return callbacks;
+}
+
+static std::vector<JniCall> getCalls(const std::string& method) {
+    std::lock_guard<std::mutex> lock(jni_stub::callsMutex);
+    std::vector<JniCall> result;
+    for (const JniCall& call : jni_stub::calls) {
+        if (call.method == method) {
+            result.push_back(call);
+        }
+    }
+    return result;
+}
+
+static bool waitForCall(const std::string& method, std::chrono::milliseconds timeout, size_t count = 1) {
+    auto end = std::chrono::steady_clock::now() + timeout;
+    while (getCalls(method).size() < count && std::chrono::steady_clock::now() < end) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return getCalls(method).size() >= count;
+}
+
+static void clearCalls() {
+    std::lock_guard<std::mutex> lock(jni_stub::callsMutex);
+    jni_stub::calls.clear();
+}
+
+// Report a stream error from a thread not attached to the JVM, like AAudio does
+static void raiseStreamError() {
+    AAudioStream* stream = aaudio_stub::lastStream;
+    std::thread([stream]() { stream->config.errorCallback(stream, nullptr, AAUDIO_ERROR_DISCONNECTED); }).join();
+}
+
+static bool hasStorageCall(StorageState state, StorageAction action) {
+    for (const JniCall& call : getCalls("onNativeStorageStateChanged")) {
+        if (call.args[0] == static_cast<int64_t>(state) && call.args[1] == static_cast<int64_t>(action)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool waitForStreamsClosed(std::chrono::milliseconds timeout) {
+    auto end = std::chrono::steady_clock::now() + timeout;
+    while (aaudio_stub::openStreams.load() != 0 && std::chrono::steady_clock::now() < end) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return aaudio_stub::openStreams.load() == 0;
+}
+
+// Check WAV header matches file contents, returns bits per sample or 0 if invalid
+static int checkWavFile(const std::string& path) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        fprintf(stderr, "Missing WAV file: %s\n", path.c_str());
+        return 0;
+    }
+    auto fileSize = static_cast<uint32_t>(file.tellg());
+    uint8_t header[44] = {};
+    file.seekg(0);
+    file.read(reinterpret_cast<char*>(header), sizeof(header));
+
+    uint32_t dataSize;
+    uint16_t bitsPerSample;
+    memcpy(&dataSize, header + 40, sizeof(dataSize));
+    memcpy(&bitsPerSample, header + 34, sizeof(bitsPerSample));
+    if (memcmp(header, "RIFF", 4) != 0 || memcmp(header + 36, "data", 4) != 0 || dataSize + 44 != fileSize) {
+        fprintf(stderr, "Invalid WAV header: %s, data size %u, file size %u\n", path.c_str(), dataSize, fileSize);
+        return 0;
+    }
+    return bitsPerSample;
+}
+
+// Read 16-bit samples following the WAV header
+static std::vector<int16_t> readSamples(const std::string& path, size_t count) {
+    std::vector<int16_t> samples(count);
+    std::ifstream file(path, std::ios::binary);
+    file.seekg(44);
+    file.read(reinterpret_cast<char*>(samples.data()), static_cast<std::streamsize>(count * sizeof(int16_t)));
+    return samples;
+}
+
+static std::string makeTempDir() {
+    char dirTemplate[] = "/tmp/storage_monitor_test_XXXXXX";
+    return mkdtemp(dirTemplate);
+}
+
+static bool getEnvDirs(std::string& smallDir, std::string& bigDir) {
+    const char* small = getenv("SMALL_DIR");
+    const char* big = getenv("BIG_DIR");
+    if (small == nullptr || big == nullptr) {
+        fprintf(stderr, "SMALL_DIR/BIG_DIR not set, run run_storage_tests.sh to mount size-limited tmpfs\n");
+        return false;
+    }
+    smallDir = small;
+    bigDir = big;
+    return true;
+}
+
+// Helpers, format conversion and free space failures, no special filesystem needed
+static int testUnit() {
+    CHECK(StorageMonitor::getDirectory("/data/rec.wav") == "/data");
+    CHECK(StorageMonitor::getDirectory("/rec.wav") == "/");
+    CHECK(StorageMonitor::getDirectory("rec.wav") == ".");
+
+    uint64_t freeBytes = 0;
+    CHECK(!StorageMonitor::queryFreeBytes("/nonexistent/storage_monitor_test", freeBytes));
+    CHECK(StorageMonitor::queryFreeBytes("/tmp", freeBytes) && freeBytes > 0);
+
+    // A failed free space query must not look like a full disk
+    StorageMonitor monitor;
+    monitor.setThresholds(60, 10);
+    monitor.reset("/nonexistent/storage_monitor_test/rec.wav", 192000);
+    std::this_thread::sleep_for(std::chrono::milliseconds(600));
+    StorageStatus status;
+    CHECK(monitor.poll(UINT32_MAX, status));
+    CHECK(status.secondsToFull == -1);
+    CHECK(status.state != StorageState::CRITICAL);
+
+    // Rotating needs a fallback on another filesystem, not a symlink or subdirectory next to the recording
+    std::string rotateDir = makeTempDir();
+    CHECK(mkdir((rotateDir + "/sub").c_str(), 0700) == 0);
+    CHECK(symlink(rotateDir.c_str(), (rotateDir + "/link").c_str()) == 0);
+    CHECK(StorageMonitor::resolveDirectory(rotateDir + "/link/sub") ==
+          StorageMonitor::resolveDirectory(rotateDir) + "/sub");
+    CHECK(StorageMonitor::isSameFilesystem(rotateDir, rotateDir + "/sub"));
+    CHECK(!StorageMonitor::isSameFilesystem(rotateDir, "/nonexistent/storage_monitor_test"));
+    g_recorder.segmentFilePath = rotateDir + "/rec.wav";
+    g_recorder.segmentFormat = AAUDIO_FORMAT_PCM_I16;
+    for (const char* fallback : {"", "/link", "/sub", "/link/sub/", "/missing"}) {
+        g_recorder.fallbackDir = (*fallback != '\0') ? rotateDir + fallback : "";
+        CHECK(!canRotateToFallback());
+    }
+    remove((rotateDir + "/link").c_str());
+    rmdir((rotateDir + "/sub").c_str());
+    rmdir(rotateDir.c_str());
+
+    // Segment names only append to the original name
+    g_recorder.segmentBaseName = getSegmentBaseName("/sdcard/my_party_mic.wav");
+    g_recorder.segmentIndex = 0;
+    CHECK(getSegmentFilePath("/sdcard") == "/sdcard/my_party_mic_part1.wav");
+    CHECK(getSegmentFilePath("/mnt/fallback/") == "/mnt/fallback/my_party_mic_part2.wav");
+
+    // Downgrade converts to 16-bit without allocating in the write path
+    std::string dir = makeTempDir();
+    const float floatSamples[4] = {0.5f, -1.0f, 2.0f, 0.0f};
+
+    WavFileWriter writer;
+    CHECK(writer.open(dir + "/float.wav", 48000, 1, AAUDIO_FORMAT_PCM_FLOAT));
+    CHECK(writer.writeData(floatSamples, sizeof(floatSamples)));
+    CHECK(writer.open(dir + "/float_part1.wav", 48000, 1, AAUDIO_FORMAT_PCM_FLOAT, AAUDIO_FORMAT_PCM_I16));
+    writer.setMaxFramesPerWrite(4);
+    int allocationsBefore = t_allocations;
+    CHECK(writer.writeData(floatSamples, sizeof(floatSamples)));
+    CHECK(t_allocations == allocationsBefore);
+    writer.close();
+
+    CHECK(checkWavFile(dir + "/float.wav") == 32);
+    CHECK(checkWavFile(dir + "/float_part1.wav") == 16);
+    CHECK(readSamples(dir + "/float_part1.wav", 4) == std::vector<int16_t>({16383, -32767, 32767, 0}));
+
+    // 24-bit packed and 32-bit keep their most significant 16 bits
+    const uint8_t i24Samples[6] = {0x00, 0x34, 0x12, 0xff, 0xff, 0xff};
+    const int32_t i32Samples[2] = {0x12345678, -65536};
+    CHECK(writer.open(dir + "/i24_part1.wav", 48000, 1, AAUDIO_FORMAT_PCM_I24_PACKED, AAUDIO_FORMAT_PCM_I16));
+    CHECK(writer.writeData(i24Samples, sizeof(i24Samples)));
+    CHECK(writer.open(dir + "/i32_part1.wav", 48000, 1, AAUDIO_FORMAT_PCM_I32, AAUDIO_FORMAT_PCM_I16));
+    CHECK(writer.writeData(i32Samples, sizeof(i32Samples)));
+    writer.close();
+    CHECK(readSamples(dir + "/i24_part1.wav", 2) == std::vector<int16_t>({0x1234, -1}));
+    CHECK(readSamples(dir + "/i32_part1.wav", 2) == std::vector<int16_t>({0x1234, -1}));
+
+    return 0;
+}
+
+// Segment hand-over: a critical threshold beyond the 32-bit WAV limit keeps any disk critical,
+// so the recording downgrades to 16-bit and then stops, without the data callback allocating
+static int testHandover() {
+    std::string dir = makeTempDir();
+    std::string path = dir + "/handover.wav";
+
+    CHECK(setConfig(48000, 2, AAUDIO_FORMAT_PCM_FLOAT, path));
+    CHECK(setStorageConfig(1000000, 1000000, StorageAction::DOWNGRADE_FORMAT, ""));
+    CHECK(startRecording());
+    std::atomic<bool> cancel{false};
+    runCallbacks(10, cancel);
+    CHECK(g_callbackAllocations == 0);
+
+    CHECK(waitForCall("onNativeRecordingError", std::chrono::seconds(2)));
+    CHECK(hasStorageCall(StorageState::CRITICAL, StorageAction::DOWNGRADE_FORMAT));
+    CHECK(hasStorageCall(StorageState::CRITICAL, StorageAction::STOP));
+    CHECK(waitForStreamsClosed(std::chrono::seconds(2)));
+    CHECK(checkWavFile(path) == 32);
+    CHECK(checkWavFile(dir + "/handover_part1.wav") == 16);
+
+    remove(path.c_str());
+    remove((dir + "/handover_part1.wav").c_str());
+    rmdir(dir.c_str());
+    return 0;
+}
+
+// Listeners may stop, release or restart the recorder from onRecordingError, which runs on the notifier thread
+static int testReentrant() {
+    std::string dir = makeTempDir();
+    std::string path = dir + "/reentrant.wav";
+    CHECK(setConfig(48000, 1, AAUDIO_FORMAT_PCM_I16, path));
+    CHECK(setStorageConfig(60, 10, StorageAction::STOP, ""));
+
+    // Retry once from the error callback
+    std::atomic<int> errors{0};
+    jni_stub::onCall = [&](const JniCall& call) {
+        if (call.method == "onNativeRecordingError" && errors++ == 0) {
+            CHECK(startRecording());
+        }
+    };
+    CHECK(startRecording());
+    raiseStreamError();
+    CHECK(waitForCall("onNativeRecordingStarted", std::chrono::seconds(2), 2));
+    CHECK(aaudio_stub::openStreams.load() == 1);
+
+    // The restarted recording has a working notifier of its own
+    raiseStreamError();
+    CHECK(waitForCall("onNativeRecordingError", std::chrono::seconds(2), 2));
+    CHECK(waitForStreamsClosed(std::chrono::seconds(2)));
+    CHECK(!stopRecording());
+
+    // Stop and release from the error callback
+    clearCalls();
+    jni_stub::onCall = [&](const JniCall& call) {
+        if (call.method == "onNativeRecordingError") {
+            CHECK(!stopRecording());
+            Java_com_example_aaudiorecorder_recorder_AAudioRecorder_releaseNative(jni_stub::env(), g_thiz);
+        }
+    };
+    CHECK(startRecording());
+    raiseStreamError();
+    CHECK(waitForCall("onNativeRecordingError", std::chrono::seconds(2)));
+    CHECK(waitForStreamsClosed(std::chrono::seconds(2)));
+    jni_stub::onCall = nullptr;
+
+    // Recorder can be initialized and used again
+    CHECK(Java_com_example_aaudiorecorder_recorder_AAudioRecorder_initializeNative(jni_stub::env(), g_thiz));
+    CHECK(startRecording());
+    CHECK(stopRecording());
+    CHECK(aaudio_stub::openStreams.load() == 0);
+    CHECK(checkWavFile(path) == 16);
+
+    remove(path.c_str());
+    rmdir(dir.c_str());
+    return 0;
+}
+
+// Throttled sink: a FIFO drained at about 100 KB/s while recording produces 192 KB/s
+static int testSlowSink() {
+    std::string dir = makeTempDir();
+    std::string sinkPath = dir + "/sink.wav";
+    CHECK(mkfifo(sinkPath.c_str(), 0600) == 0);
+
+    std::thread reader([&]() {
+        std::ifstream sink(sinkPath, std::ios::binary);
+        std::vector<char> chunk(10000);
+        while (sink.read(chunk.data(), static_cast<std::streamsize>(chunk.size())) || sink.gcount() > 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        }
+    });
+
+    CHECK(setConfig(48000, 2, AAUDIO_FORMAT_PCM_I16, sinkPath));
+    CHECK(setStorageConfig(2, 1, StorageAction::NONE, ""));
+    CHECK(startRecording());
+
+    std::atomic<bool> cancel{false};
+    std::thread watcher([&]() {
+        auto end = std::chrono::steady_clock::now() + std::chrono::seconds(8);
+        while (!hasStorageCall(StorageState::SLOW, StorageAction::NONE) && std::chrono::steady_clock::now() < end) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        cancel.store(true);
+    });
+    runCallbacks(10, cancel);
+    watcher.join();
+
+    CHECK(hasStorageCall(StorageState::SLOW, StorageAction::NONE));
+    CHECK(g_callbackAllocations == 0);
+    CHECK(stopRecording());
+    CHECK(aaudio_stub::openStreams.load() == 0);
+    reader.join();
+    return 0;
+}
+
+// Storage action STOP: file is finalized, stream closed off the callback and Java told
+static int testStop() {
+    std::string smallDir, bigDir;
+    if (!getEnvDirs(smallDir, bigDir)) {
+        return SKIP;
+    }
+    std::string path = smallDir + "/stop.wav";
+
+    CHECK(setConfig(96000, 2, AAUDIO_FORMAT_PCM_I32, path));
+    CHECK(setStorageConfig(2, 1, StorageAction::STOP, ""));
+    CHECK(startRecording());
+    std::atomic<bool> cancel{false};
+    runCallbacks(20, cancel);
+    CHECK(g_callbackAllocations == 0);
+
+    CHECK(waitForCall("onNativeRecordingError", std::chrono::seconds(2)));
+    CHECK(!getCalls("onNativeRecordingError").empty() &&
+          getCalls("onNativeRecordingError")[0].text == "Recording stopped: storage almost full");
+    CHECK(hasStorageCall(StorageState::CRITICAL, StorageAction::STOP));
+    CHECK(waitForStreamsClosed(std::chrono::seconds(2)));
+    CHECK(checkWavFile(path) == 32);
+
+    // Nothing left to stop, and a new recording does not leak the old stream
+    CHECK(!stopRecording());
+    remove(path.c_str());
+    CHECK(startRecording());
+    CHECK(aaudio_stub::openStreams.load() == 1);
+    CHECK(stopRecording());
+    CHECK(aaudio_stub::openStreams.load() == 0);
+    remove(path.c_str());
+    return 0;
+}
+
+// Storage action DOWNGRADE_FORMAT: continue in 16-bit, stop when that runs out too
+static int testDowngrade() {
+    std::string smallDir, bigDir;
+    if (!getEnvDirs(smallDir, bigDir)) {
+        return SKIP;
+    }
+    std::string path = smallDir + "/downgrade.wav";
+
+    CHECK(setConfig(96000, 2, AAUDIO_FORMAT_PCM_FLOAT, path));
+    CHECK(setStorageConfig(2, 1, StorageAction::DOWNGRADE_FORMAT, ""));
+    CHECK(startRecording());
+    std::atomic<bool> cancel{false};
+    runCallbacks(20, cancel);
+    CHECK(g_callbackAllocations == 0);
+
+    CHECK(waitForCall("onNativeRecordingError", std::chrono::seconds(2)));
+    CHECK(hasStorageCall(StorageState::CRITICAL, StorageAction::DOWNGRADE_FORMAT));
+    CHECK(hasStorageCall(StorageState::CRITICAL, StorageAction::STOP));
+    CHECK(waitForStreamsClosed(std::chrono::seconds(2)));
+    CHECK(checkWavFile(path) == 32);
+    CHECK(checkWavFile(smallDir + "/downgrade_part1.wav") == 16);
+
+    remove(path.c_str());
+    remove((smallDir + "/downgrade_part1.wav").c_str());
+    return 0;
+}
+
+// Storage action ROTATE_DIRECTORY: continue in the fallback directory, stop when that runs out too
+static int testRotate() {
+    std::string smallDir, bigDir;
+    if (!getEnvDirs(smallDir, bigDir)) {
+        return SKIP;
+    }
+    std::string path = smallDir + "/rotate.wav";
+
+    // Fallback must hold more than the critical time of recording
+    CHECK(setConfig(96000, 2, AAUDIO_FORMAT_PCM_I32, path));
+    g_recorder.segmentFilePath = path;
+    g_recorder.segmentFormat = AAUDIO_FORMAT_PCM_I32;
+    g_recorder.fallbackDir = bigDir;
+    g_recorder.criticalSeconds = 1;
+    CHECK(canRotateToFallback());
+    g_recorder.criticalSeconds = 10;
+    CHECK(!canRotateToFallback());
+
+    CHECK(setStorageConfig(2, 1, StorageAction::ROTATE_DIRECTORY, bigDir + "/"));
+    CHECK(startRecording());
+    std::atomic<bool> cancel{false};
+    runCallbacks(30, cancel);
+    CHECK(g_callbackAllocations == 0);
+
+    CHECK(waitForCall("onNativeRecordingError", std::chrono::seconds(2)));
+    CHECK(hasStorageCall(StorageState::CRITICAL, StorageAction::ROTATE_DIRECTORY));
+    CHECK(hasStorageCall(StorageState::CRITICAL, StorageAction::STOP));
+    CHECK(waitForStreamsClosed(std::chrono::seconds(2)));
+    CHECK(checkWavFile(path) == 32);
+    CHECK(checkWavFile(bigDir + "/rotate_part1.wav") == 32);
+
+    remove(path.c_str());
+    remove((bigDir + "/rotate_part1.wav").c_str());
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    if (argc != 2) {
+        fprintf(stderr, "Usage: %s unit|handover|reentrant|slow_sink|stop|downgrade|rotate\n", argv[0]);
+        return 2;
+    }
+
+    // The main thread plays the Java thread calling into the recorder
+    jni_stub::attached = true;
+    CHECK(Java_com_example_aaudiorecorder_recorder_AAudioRecorder_initializeNative(jni_stub::env(), g_thiz));
+
+    std::string name = argv[1];
+    int result;
+    if (name == "unit") {
+        result = testUnit();
+    } else if (name == "handover") {
+        result = testHandover();
+    } else if (name == "reentrant") {
+        result = testReentrant();
+    } else if (name == "slow_sink") {
+        result = testSlowSink();
+    } else if (name == "stop") {
+        result = testStop();
+    } else if (name == "downgrade") {
+        result = testDowngrade();
+    } else if (name == "rotate") {
+        result = testRotate();
+    } else {
+        fprintf(stderr, "Unknown test: %s\n", name.c_str());
+        return 2;
+    }
+
+    Java_com_example_aaudiorecorder_recorder_AAudioRecorder_releaseNative(jni_stub::env(), g_thiz);
+
+    if (result == SKIP) {
+        return SKIP;
+    }
+    fprintf(stderr, "%s: %s\n", name.c_str(), g_failures == 0 ? "PASSED" : "FAILED");
+    return g_failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,121 @@
+// Host stub of <aaudio/AAudio.h> for native tests
+// Streams are never driven by the stub, tests invoke the data callback themselves
+#ifndef AAUDIO_STUB_H
+#define AAUDIO_STUB_H
+
+#include <atomic>
+#include <cstdint>
+
+typedef int32_t aaudio_result_t;
+typedef int32_t aaudio_format_t;
+typedef int32_t aaudio_direction_t;
+typedef int32_t aaudio_input_preset_t;
+typedef int32_t aaudio_performance_mode_t;
+typedef int32_t aaudio_sharing_mode_t;
+typedef int32_t aaudio_data_callback_result_t;
+
+enum {
+    AAUDIO_OK = 0,
+    AAUDIO_ERROR_DISCONNECTED = -899,
+    AAUDIO_DIRECTION_INPUT = 1,
+    AAUDIO_FORMAT_UNSPECIFIED = 0,
+    AAUDIO_FORMAT_PCM_I16 = 1,
+    AAUDIO_FORMAT_PCM_FLOAT = 2,
+    AAUDIO_FORMAT_PCM_I24_PACKED = 3,
+    AAUDIO_FORMAT_PCM_I32 = 4,
+    AAUDIO_INPUT_PRESET_GENERIC = 1,
+    AAUDIO_PERFORMANCE_MODE_LOW_LATENCY = 12,
+    AAUDIO_SHARING_MODE_SHARED = 1,
+    AAUDIO_CALLBACK_RESULT_CONTINUE = 0,
+    AAUDIO_CALLBACK_RESULT_STOP = 1,
+};
+
+struct AAudioStream;
+typedef aaudio_data_callback_result_t (*AAudioStream_dataCallback)(AAudioStream* stream,
+                                                                   void* userData,
+                                                                   void* audioData,
+                                                                   int32_t numFrames);
+typedef void (*AAudioStream_errorCallback)(AAudioStream* stream, void* userData, aaudio_result_t error);
+
+struct AAudioStreamBuilder {
+    int32_t sampleRate = 48000;
+    int32_t channelCount = 1;
+    aaudio_format_t format = AAUDIO_FORMAT_PCM_I16;
+    AAudioStream_dataCallback dataCallback = nullptr;
+    AAudioStream_errorCallback errorCallback = nullptr;
+};
+
+struct AAudioStream {
+    AAudioStreamBuilder config;
+    bool started = false;
+};
+
+namespace aaudio_stub {
+inline constexpr int32_t FRAMES_PER_BURST = 480;
+inline std::atomic<int32_t> openStreams{0};
+inline AAudioStream* lastStream = nullptr;
+} // namespace aaudio_stub
+
+inline const char* AAudio_convertResultToText(aaudio_result_t result) {
+    return result == AAUDIO_OK ? "AAUDIO_OK" : "AAUDIO_ERROR";
+}
+
+inline aaudio_result_t AAudio_createStreamBuilder(AAudioStreamBuilder** builder) {
+    *builder = new AAudioStreamBuilder();
+    return AAUDIO_OK;
+}
+
+inline void AAudioStreamBuilder_setDirection(AAudioStreamBuilder*, aaudio_direction_t) {}
+inline void AAudioStreamBuilder_setSampleRate(AAudioStreamBuilder* b, int32_t rate) { b->sampleRate = rate; }
+inline void AAudioStreamBuilder_setChannelCount(AAudioStreamBuilder* b, int32_t count) { b->channelCount = count; }
+inline void AAudioStreamBuilder_setFormat(AAudioStreamBuilder* b, aaudio_format_t format) { b->format = format; }
+inline void AAudioStreamBuilder_setPerformanceMode(AAudioStreamBuilder*, aaudio_performance_mode_t) {}
+inline void AAudioStreamBuilder_setSharingMode(AAudioStreamBuilder*, aaudio_sharing_mode_t) {}
+inline void AAudioStreamBuilder_setInputPreset(AAudioStreamBuilder*, aaudio_input_preset_t) {}
+
+inline void AAudioStreamBuilder_setDataCallback(AAudioStreamBuilder* b, AAudioStream_dataCallback callback, void*) {
+    b->dataCallback = callback;
+}
+
+inline void AAudioStreamBuilder_setErrorCallback(AAudioStreamBuilder* b, AAudioStream_errorCallback callback, void*) {
+    b->errorCallback = callback;
+}
+
+inline aaudio_result_t AAudioStreamBuilder_openStream(AAudioStreamBuilder* b, AAudioStream** stream) {
+    *stream = new AAudioStream{*b, false};
+    aaudio_stub::lastStream = *stream;
+    aaudio_stub::openStreams++;
+    return AAUDIO_OK;
+}
+
+inline aaudio_result_t AAudioStreamBuilder_delete(AAudioStreamBuilder* b) {
+    delete b;
+    return AAUDIO_OK;
+}
+
+inline int32_t AAudioStream_getSampleRate(AAudioStream* s) { return s->config.sampleRate; }
+inline int32_t AAudioStream_getChannelCount(AAudioStream* s) { return s->config.channelCount; }
+inline aaudio_format_t AAudioStream_getFormat(AAudioStream* s) { return s->config.format; }
+inline int32_t AAudioStream_getFramesPerBurst(AAudioStream*) { return aaudio_stub::FRAMES_PER_BURST; }
+inline int32_t AAudioStream_getBufferCapacityInFrames(AAudioStream*) { return aaudio_stub::FRAMES_PER_BURST * 4; }
+
+inline aaudio_result_t AAudioStream_requestStart(AAudioStream* s) {
+    s->started = true;
+    return AAUDIO_OK;
+}
+
+inline aaudio_result_t AAudioStream_requestStop(AAudioStream* s) {
+    s->started = false;
+    return AAUDIO_OK;
+}
+
+inline aaudio_result_t AAudioStream_close(AAudioStream* s) {
+    if (aaudio_stub::lastStream == s) {
+        aaudio_stub::lastStream = nullptr;
+    }
+    delete s;
+    aaudio_stub::openStreams--;
+    return AAUDIO_OK;
+}
+
+#endif // AAUDIO_STUB_H
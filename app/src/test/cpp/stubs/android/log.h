@@ -0,0 +1,16 @@
+// Host stub of <android/log.h> for native tests, prints to stderr
+#ifndef ANDROID_LOG_STUB_H
+#define ANDROID_LOG_STUB_H
+
+#include <cstdio>
+
+enum {
+    ANDROID_LOG_DEBUG = 3,
+    ANDROID_LOG_INFO = 4,
+    ANDROID_LOG_WARN = 5,
+    ANDROID_LOG_ERROR = 6,
+};
+
+#define __android_log_print(prio, tag, ...) (fprintf(stderr, "[%s] ", tag), fprintf(stderr, __VA_ARGS__), fputc('\n', stderr))
+
+#endif // ANDROID_LOG_STUB_H
@@ -0,0 +1,132 @@
+// Host stub of <jni.h> for native tests
+// Records Java callbacks and, like ART, only hands out a JNIEnv on threads attached to the VM
+#ifndef JNI_STUB_H
+#define JNI_STUB_H
+
+#include <cstdarg>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+typedef uint8_t jboolean;
+typedef int32_t jint;
+typedef int64_t jlong;
+
+struct _jobject {
+    std::string value; // String contents for jstring
+};
+typedef _jobject* jobject;
+typedef jobject jclass;
+typedef jobject jstring;
+
+struct _jmethodID {
+    std::string name;
+};
+typedef _jmethodID* jmethodID;
+
+#define JNIEXPORT
+#define JNICALL
+#define JNI_FALSE 0
+#define JNI_TRUE 1
+#define JNI_OK 0
+#define JNI_EDETACHED (-2)
+#define JNI_VERSION_1_6 0x00010006
+
+// Java callback received through CallVoidMethod
+struct JniCall {
+    std::string method;
+    std::vector<int64_t> args; // Integer arguments
+    std::string text;          // String argument
+    std::thread::id thread;
+};
+
+struct JNIEnv;
+
+namespace jni_stub {
+inline thread_local bool attached = false;
+inline std::mutex callsMutex;
+inline std::vector<JniCall> calls;
+inline std::map<std::string, _jmethodID> methods;
+inline std::function<void(const JniCall&)> onCall; // Runs on the calling thread, like a Java listener
+JNIEnv* env();
+} // namespace jni_stub
+
+struct JavaVM {
+    jint GetEnv(void** env, jint) {
+        if (!jni_stub::attached) {
+            return JNI_EDETACHED;
+        }
+        *env = jni_stub::env();
+        return JNI_OK;
+    }
+
+    jint AttachCurrentThread(JNIEnv** env, void*) {
+        jni_stub::attached = true;
+        *env = jni_stub::env();
+        return JNI_OK;
+    }
+
+    jint DetachCurrentThread() {
+        jni_stub::attached = false;
+        return JNI_OK;
+    }
+};
+
+struct JNIEnv {
+    JavaVM vm;
+
+    jint GetJavaVM(JavaVM** result) {
+        *result = &vm;
+        return JNI_OK;
+    }
+
+    jobject NewGlobalRef(jobject obj) { return obj; }
+    void DeleteGlobalRef(jobject) {}
+    void DeleteLocalRef(jobject obj) { delete obj; }
+    jclass GetObjectClass(jobject obj) { return new _jobject(*obj); }
+
+    jmethodID GetMethodID(jclass, const char* name, const char*) {
+        _jmethodID& method = jni_stub::methods[name];
+        method.name = name;
+        return &method;
+    }
+
+    jstring NewStringUTF(const char* str) { return new _jobject{str}; }
+    const char* GetStringUTFChars(jstring str, void*) { return str->value.c_str(); }
+    void ReleaseStringUTFChars(jstring, const char*) {}
+
+    // Decode arguments by callback name, matching the signatures looked up by initializeNative
+    void CallVoidMethod(jobject, jmethodID method, ...) {
+        JniCall call{method->name, {}, {}, std::this_thread::get_id()};
+        va_list args;
+        va_start(args, method);
+        if (call.method == "onNativeRecordingError") {
+            call.text = va_arg(args, jstring)->value;
+        } else if (call.method == "onNativeStorageStateChanged") {
+            call.args.push_back(va_arg(args, jint));
+            call.args.push_back(va_arg(args, jint));
+            call.args.push_back(va_arg(args, jlong));
+            call.args.push_back(va_arg(args, jlong));
+        }
+        va_end(args);
+
+        {
+            std::lock_guard<std::mutex> lock(jni_stub::callsMutex);
+            jni_stub::calls.push_back(call);
+        }
+        if (jni_stub::onCall) {
+            jni_stub::onCall(call);
+        }
+    }
+};
+
+inline JNIEnv* jni_stub::env() {
+    static JNIEnv instance;
+    return &instance;
+}
+
+#endif // JNI_STUB_H
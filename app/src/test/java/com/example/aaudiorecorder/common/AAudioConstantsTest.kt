@@ -0,0 +1,46 @@
+package com.example.aaudiorecorder.common
+
+import org.junit.Assert.assertEquals
+import org.junit.Test
+
+/**
+ * Storage action mapping of AAudioConstants
+ */
+class AAudioConstantsTest {
+    @Test
+    fun storageAction_mapsToNativeValues() {
+        assertEquals(AAudioConstants.Storage.ACTION_NONE, AAudioConstants.getStorageAction("STORAGE_ACTION_NONE"))
+        assertEquals(AAudioConstants.Storage.ACTION_STOP, AAudioConstants.getStorageAction("STORAGE_ACTION_STOP"))
+        assertEquals(
+            AAudioConstants.Storage.ACTION_DOWNGRADE_FORMAT,
+            AAudioConstants.getStorageAction("STORAGE_ACTION_DOWNGRADE_FORMAT")
+        )
+        assertEquals(
+            AAudioConstants.Storage.ACTION_ROTATE_DIRECTORY,
+            AAudioConstants.getStorageAction("STORAGE_ACTION_ROTATE_DIRECTORY")
+        )
+    }
+
+    @Test
+    fun storageAction_matchesNativeEnum() {
+        // Must match StorageAction in aaudio_recorder.h
+        assertEquals(0, AAudioConstants.Storage.ACTION_NONE)
+        assertEquals(1, AAudioConstants.Storage.ACTION_STOP)
+        assertEquals(2, AAudioConstants.Storage.ACTION_DOWNGRADE_FORMAT)
+        assertEquals(3, AAudioConstants.Storage.ACTION_ROTATE_DIRECTORY)
+    }
+
+    @Test
+    fun unknownStorageAction_fallsBackToStop() {
+        assertEquals(AAudioConstants.Storage.ACTION_STOP, AAudioConstants.getStorageAction("STORAGE_ACTION_UNKNOWN"))
+        assertEquals(AAudioConstants.Storage.ACTION_STOP, AAudioConstants.getStorageAction(""))
+    }
+
+    @Test
+    fun defaultStorageAction_isStop() {
+        assertEquals(
+            AAudioConstants.Storage.ACTION_STOP,
+            AAudioConstants.getStorageAction(AAudioConstants.DEFAULT_STORAGE_ACTION)
+        )
+    }
+}
@@ -0,0 +1,43 @@
+package com.example.aaudiorecorder.config
+
+import com.example.aaudiorecorder.common.AAudioConstants
+import org.junit.Assert.assertEquals
+import org.junit.Assert.assertThrows
+import org.junit.Test
+
+/**
+ * Storage threshold validation of AAudioConfig
+ */
+class AAudioConfigTest {
+    @Test
+    fun defaultStorageConfig_isValid() {
+        val config = AAudioConfig()
+        assertEquals(AAudioConstants.DEFAULT_LOW_SPACE_SECONDS, config.lowSpaceSeconds)
+        assertEquals(AAudioConstants.DEFAULT_CRITICAL_SECONDS, config.criticalSeconds)
+        assertEquals(AAudioConstants.DEFAULT_STORAGE_ACTION, config.storageAction)
+        assertEquals("", config.fallbackDir)
+    }
+
+    @Test
+    fun equalThresholds_areAccepted() {
+        val config = AAudioConfig(lowSpaceSeconds = 10, criticalSeconds = 10)
+        assertEquals(10, config.lowSpaceSeconds)
+    }
+
+    @Test
+    fun nonPositiveCriticalThreshold_isRejected() {
+        assertThrows(IllegalArgumentException::class.java) {
+            AAudioConfig(lowSpaceSeconds = 60, criticalSeconds = 0)
+        }
+        assertThrows(IllegalArgumentException::class.java) {
+            AAudioConfig(lowSpaceSeconds = 60, criticalSeconds = -1)
+        }
+    }
+
+    @Test
+    fun lowSpaceBelowCriticalThreshold_isRejected() {
+        assertThrows(IllegalArgumentException::class.java) {
+            AAudioConfig(lowSpaceSeconds = 5, criticalSeconds = 10)
+        }
+    }
+}